@@ -8,6 +8,13 @@
 #include <fstream>
 #include <set>
 #include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <numeric>
+#include <map>
+#include <limits>
+#include "ThreadPool.cpp"
 
 using namespace std;
 /* 
@@ -262,6 +269,160 @@ public:
          return graph;
       }
 
+    // Marks the absence of a vertex, e.g. no target or no predecessor
+    static const unsigned int NO_VERTEX = (unsigned int)-1;
+
+    /* The result of a single source shortest paths search, indexed by vertex.
+       If the search stopped early at a target, only the target and vertices
+       closer to the source than it are guaranteed to be final.
+    */
+    class ShortestPaths {
+    public:
+        unsigned int source;
+        vector<Weight> distances;           // Only meaningful where reached
+        vector<unsigned int> predecessors;  // NO_VERTEX for the source and
+                                            // unreached vertices
+        vector<bool> reached;
+        ShortestPaths(unsigned int source, unsigned int noOfVertices):
+            source(source), distances(noOfVertices, Weight(0)),
+            predecessors(noOfVertices, NO_VERTEX), reached(noOfVertices, false){
+               reached[source] = true;
+        }
+        bool isReachable(unsigned int vertex) const{
+               return reached.at(vertex);
+        }
+        // Returns the distance from the source.
+        // throws: out_of_range if vertex is not reachable
+        Weight getDistance(unsigned int vertex) const{
+               if (!isReachable(vertex)) {
+                  throw out_of_range("Vertex is not reachable from the source");
+               }
+               return distances[vertex];
+        }
+        // Returns the vertices along the shortest path from the source to
+        // vertex inclusive, or an empty path if vertex is not reachable
+        vector<unsigned int> getPath(unsigned int vertex) const{
+               vector<unsigned int> path;
+               if (!isReachable(vertex)) {
+                  return path;
+               }
+               for (unsigned int v = vertex; v != NO_VERTEX; v = predecessors[v]) {
+                  path.push_back(v);
+               }
+               reverse(path.begin(), path.end());
+               return path;
+        }
+    };
+
+    /* Returns the shortest paths from source using Dijkstra's algorithm with
+       an indexed binary heap. If a target is given the search stops as soon
+       as the target's distance is known.
+       throws: out_of_range if a vertex is invalid or a weight is negative
+    */
+    ShortestPaths getDijkstrasShortestPaths(unsigned int source,
+         unsigned int target = NO_VERTEX){
+         checkVertex(source);
+         if (target != NO_VERTEX) {
+            checkVertex(target);
+         }
+         ShortestPaths paths(source, noOfVertices);
+         dijkstra(paths, target, NULL);
+         return paths;
+      }
+
+    /* Returns the shortest paths from source using delta-stepping, relaxing
+       the edges of each bucket's vertices across the pool. Vertices are kept
+       in buckets of width delta; a delta of 0 chooses the maximum weight over
+       the average degree. If a target is given the search stops once the
+       target's bucket has been settled.
+       throws: out_of_range if a vertex is invalid or a weight is negative
+    */
+    ShortestPaths getDeltaSteppingShortestPaths(unsigned int source,
+         ThreadPool& pool, unsigned int target = NO_VERTEX, Weight delta = Weight(0)){
+         checkVertex(source);
+         if (target != NO_VERTEX) {
+            checkVertex(target);
+         }
+         Adjacency adjacency = buildAdjacency(pool);
+         if (!(delta > Weight(0))) {
+            delta = getDefaultDelta(adjacency);
+         }
+         ShortestPaths paths(source, noOfVertices);
+         // Only non-empty buckets are stored, so memory and time depend on the
+         // graph rather than on the largest distance over delta
+         map<unsigned long, vector<unsigned int> > buckets;
+         buckets[0].push_back(source);
+         vector<vector<Request> > requests(pool.getNoOfThreads());
+         // Stamps so each vertex appears at most once per frontier and once
+         // in the vertices settled by a pass over a bucket
+         vector<unsigned long> queuedIn(noOfVertices, 0);
+         vector<unsigned long> settledIn(noOfVertices, 0);
+         unsigned long round = 0;
+         unsigned long pass = 0;
+         while (!buckets.empty()) {
+            unsigned long bucket = buckets.begin()->first;
+            vector<unsigned int> settled;
+            pass++;
+            // Light edges can refill the current bucket, so repeat until empty
+            typename map<unsigned long, vector<unsigned int> >::iterator itr;
+            while ((itr = buckets.find(bucket)) != buckets.end()) {
+                  vector<unsigned int> pending;
+                  pending.swap(itr->second);
+                  buckets.erase(itr);
+                  vector<unsigned int> frontier;
+                  round++;
+                  for (unsigned int i = 0; i < pending.size(); i++) {
+                     unsigned int vertex = pending[i];
+                     // Skip duplicates and vertices since moved to a lower bucket
+                     if (queuedIn[vertex] == round ||
+                           getBucket(paths.distances[vertex], delta) != bucket) {
+                        continue;
+                     }
+                     queuedIn[vertex] = round;
+                     frontier.push_back(vertex);
+                     if (settledIn[vertex] != pass) {
+                        settledIn[vertex] = pass;
+                        settled.push_back(vertex);
+                     }
+                  }
+                  relaxEdges(frontier, true, delta, adjacency, paths, buckets,
+                        requests, pool);
+            }
+            // Heavy edges lead to a later bucket, unless getBucket saturated,
+            // in which case the same bucket is simply taken again
+            relaxEdges(settled, false, delta, adjacency, paths, buckets,
+                  requests, pool);
+            if (target != NO_VERTEX && paths.reached[target] &&
+                  getBucket(paths.distances[target], delta) <= bucket &&
+                  (buckets.empty() || buckets.begin()->first > bucket)) {
+                  break;
+            }
+         }
+         return paths;
+      }
+
+    /* Returns the shortest paths from each of the sources. The pool's workers
+       share one adjacency list and each run Dijkstra's algorithm for one
+       source at a time.
+       throws: out_of_range if a vertex is invalid or a weight is negative
+    */
+    vector<ShortestPaths> getShortestPaths(const vector<unsigned int>& sources,
+         ThreadPool& pool){
+         for (unsigned int i = 0; i < sources.size(); i++) {
+            checkVertex(sources[i]);
+         }
+         Adjacency adjacency = buildAdjacency(pool);
+         vector<ShortestPaths> paths;
+         paths.reserve(sources.size());
+         for (unsigned int i = 0; i < sources.size(); i++) {
+            paths.push_back(ShortestPaths(sources[i], noOfVertices));
+         }
+         pool.parallelFor(sources.size(), [&](unsigned int, unsigned long i){
+            dijkstra(paths[i], NO_VERTEX, &adjacency);
+         });
+         return paths;
+      }
+
 private:
     // Initializes as empty graph of required size
     void init(unsigned int noOfVertices){
@@ -293,6 +454,257 @@ private:
          }
       }
 
+    // Each vertex's edges, gathered from the weights array so searches do not
+    // have to scan every other vertex
+    class Adjacency {
+    public:
+        vector<unsigned long> offsets;    // Edges of vertex v are
+                                          // [offsets[v], offsets[v + 1])
+        vector<unsigned int> vertices;
+        vector<Weight> weights;
+    };
+
+    // A distance improvement found during delta-stepping
+    class Request {
+    public:
+        unsigned int vertex;
+        unsigned int predecessor;
+        Weight distance;
+        Request(unsigned int vertex, unsigned int predecessor, Weight distance):
+            vertex(vertex), predecessor(predecessor), distance(distance){}
+    };
+
+    /* A binary min heap of vertices ordered by their keys, which can also
+       move a vertex up after its key has been lowered.
+    */
+    class IndexedHeap {
+    private:
+        vector<unsigned int> heap;        // Vertices in heap order
+        vector<unsigned int> positions;   // Index in heap of each vertex
+        const vector<Weight>& keys;
+    public:
+        IndexedHeap(const vector<Weight>& keys):
+            positions(keys.size(), NO_VERTEX), keys(keys){}
+        bool empty() const{
+               return heap.empty();
+        }
+        // Inserts vertex, or reorders it if its key has been lowered
+        void push(unsigned int vertex){
+               if (positions[vertex] == NO_VERTEX) {
+                  positions[vertex] = heap.size();
+                  heap.push_back(vertex);
+               }
+               siftUp(positions[vertex]);
+        }
+        // Removes and returns the vertex with the smallest key
+        unsigned int pop(){
+               unsigned int top = heap[0];
+               unsigned int last = heap.back();
+               heap.pop_back();
+               positions[top] = NO_VERTEX;
+               if (!heap.empty()) {
+                  heap[0] = last;
+                  positions[last] = 0;
+                  siftDown(0);
+               }
+               return top;
+        }
+    private:
+        void siftUp(unsigned int i){
+               unsigned int vertex = heap[i];
+               while (i > 0) {
+                  unsigned int parent = (i - 1) / 2;
+                  if (!(keys[vertex] < keys[heap[parent]])) {
+                     break;
+                  }
+                  heap[i] = heap[parent];
+                  positions[heap[i]] = i;
+                  i = parent;
+               }
+               heap[i] = vertex;
+               positions[vertex] = i;
+        }
+        void siftDown(unsigned int i){
+               unsigned int vertex = heap[i];
+               unsigned int size = heap.size();
+               while (2 * i + 1 < size) {
+                  unsigned int child = 2 * i + 1;
+                  if (child + 1 < size && keys[heap[child + 1]] < keys[heap[child]]) {
+                     child++;
+                  }
+                  if (!(keys[heap[child]] < keys[vertex])) {
+                     break;
+                  }
+                  heap[i] = heap[child];
+                  positions[heap[i]] = i;
+                  i = child;
+               }
+               heap[i] = vertex;
+               positions[vertex] = i;
+        }
+    };
+
+    void checkVertex(unsigned int vertex){
+         if (vertex >= noOfVertices) {
+            throw out_of_range("Vertex out of range");
+         }
+      }
+
+    void checkNonNegative(Weight weight){
+         if (weight < Weight(0)) {
+            throw out_of_range("Shortest paths require non-negative weights");
+         }
+      }
+
+    // Builds the adjacency list, one vertex per task: first counting each
+    // vertex's edges and then, once offsets are known, filling them in
+    Adjacency buildAdjacency(ThreadPool& pool){
+         Adjacency adjacency;
+         adjacency.offsets.assign(noOfVertices + 1, 0);
+         pool.parallelFor(noOfVertices, [&](unsigned int, unsigned long vertex){
+            unsigned long degree = 0;
+            for (unsigned int adj = 0; adj < noOfVertices; adj++) {
+                  if (adj != vertex && getWeight(vertex, adj) != DISCONNECTED) {
+                     degree++;
+                  }
+            }
+            adjacency.offsets[vertex + 1] = degree;
+         });
+         partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(),
+               adjacency.offsets.begin());
+         adjacency.vertices.resize(adjacency.offsets[noOfVertices]);
+         adjacency.weights.resize(adjacency.offsets[noOfVertices]);
+         pool.parallelFor(noOfVertices, [&](unsigned int, unsigned long vertex){
+            unsigned long k = adjacency.offsets[vertex];
+            for (unsigned int adj = 0; adj < noOfVertices; adj++) {
+                  if (adj != vertex) {
+                     Weight weight = getWeight(vertex, adj);
+                     if (weight != DISCONNECTED) {
+                        checkNonNegative(weight);
+                        adjacency.vertices[k] = adj;
+                        adjacency.weights[k] = weight;
+                        k++;
+                     }
+                  }
+            }
+         });
+         return adjacency;
+      }
+
+    // Returns the maximum weight over the average degree, at least 1
+    Weight getDefaultDelta(const Adjacency& adjacency){
+         Weight maxWeight = Weight(0);
+         for (unsigned long k = 0; k < adjacency.weights.size(); k++) {
+            if (maxWeight < adjacency.weights[k]) {
+                  maxWeight = adjacency.weights[k];
+            }
+         }
+         unsigned long degree = adjacency.weights.size() / noOfVertices;
+         Weight delta = maxWeight / Weight(degree > 1 ? degree : 1);
+         return delta > Weight(0) ? delta : Weight(1);
+      }
+
+    // Returns distance / delta, saturating rather than overflowing the cast
+    unsigned long getBucket(Weight distance, Weight delta){
+         if ((double)distance / (double)delta >=
+               (double)numeric_limits<unsigned long>::max()) {
+            return numeric_limits<unsigned long>::max();
+         }
+         return (unsigned long)(distance / delta);
+      }
+
+    /* Relaxes either the light (weight <= delta) or heavy edges of vertices.
+       Workers only collect improvements into their own requests, which are
+       then applied here so distances and buckets need no locking.
+    */
+    void relaxEdges(const vector<unsigned int>& vertices, bool light,
+         Weight delta, const Adjacency& adjacency, ShortestPaths& paths,
+         map<unsigned long, vector<unsigned int> >& buckets,
+         vector<vector<Request> >& requests, ThreadPool& pool){
+         const unsigned long CHUNK = 64;
+         unsigned long noOfChunks = (vertices.size() + CHUNK - 1) / CHUNK;
+         pool.parallelFor(noOfChunks, [&](unsigned int worker, unsigned long chunk){
+            unsigned long end = min((unsigned long)vertices.size(), (chunk + 1) * CHUNK);
+            for (unsigned long i = chunk * CHUNK; i < end; i++) {
+                  unsigned int vertex = vertices[i];
+                  Weight distance = paths.distances[vertex];
+                  for (unsigned long k = adjacency.offsets[vertex];
+                        k < adjacency.offsets[vertex + 1]; k++) {
+                     Weight weight = adjacency.weights[k];
+                     if ((weight <= delta) != light) {
+                        continue;
+                     }
+                     unsigned int adj = adjacency.vertices[k];
+                     Weight newDistance = distance + weight;
+                     if (!paths.reached[adj] || newDistance < paths.distances[adj]) {
+                        requests[worker].push_back(Request(adj, vertex, newDistance));
+                     }
+                  }
+            }
+         });
+         for (unsigned int worker = 0; worker < requests.size(); worker++) {
+            for (unsigned long i = 0; i < requests[worker].size(); i++) {
+                  const Request& request = requests[worker][i];
+                  unsigned int adj = request.vertex;
+                  if (paths.reached[adj] && !(request.distance < paths.distances[adj])) {
+                     continue;
+                  }
+                  paths.reached[adj] = true;
+                  paths.distances[adj] = request.distance;
+                  paths.predecessors[adj] = request.predecessor;
+                  buckets[getBucket(request.distance, delta)].push_back(adj);
+            }
+            requests[worker].clear();
+         }
+      }
+
+    /* Dijkstra's algorithm from paths.source, stopping once target is settled.
+       Edges come from adjacency if given, otherwise straight from the weights
+       array, which avoids building the list for a single early-stopping query.
+    */
+    void dijkstra(ShortestPaths& paths, unsigned int target,
+         const Adjacency* adjacency){
+         vector<bool> settled(noOfVertices, false);
+         IndexedHeap heap(paths.distances);
+         heap.push(paths.source);
+         while (!heap.empty()) {
+            unsigned int vertex = heap.pop();
+            settled[vertex] = true;
+            if (vertex == target) {
+                  break;
+            }
+            Weight distance = paths.distances[vertex];
+            auto relax = [&](unsigned int adj, Weight weight){
+                  checkNonNegative(weight);
+                  if (settled[adj]) {
+                     return;
+                  }
+                  Weight newDistance = distance + weight;
+                  if (!paths.reached[adj] || newDistance < paths.distances[adj]) {
+                     paths.reached[adj] = true;
+                     paths.distances[adj] = newDistance;
+                     paths.predecessors[adj] = vertex;
+                     heap.push(adj);
+                  }
+            };
+            if (adjacency != NULL) {
+                  for (unsigned long k = adjacency->offsets[vertex];
+                        k < adjacency->offsets[vertex + 1]; k++) {
+                     relax(adjacency->vertices[k], adjacency->weights[k]);
+                  }
+            } else {
+                  for (unsigned int adj = 0; adj < noOfVertices; adj++) {
+                     if (adj != vertex) {
+                        Weight weight = getWeight(vertex, adj);
+                        if (weight != DISCONNECTED) {
+                           relax(adj, weight);
+                        }
+                     }
+                  }
+            }
+         }
+      }
+
     /* This Edge's call is used in the priority queues in Kruskals and Prims
        minimum spanning tree methods: getKruskalsMinimumSpanningTree,
        getPrimsMinimumSpanningTree.
@@ -310,4 +722,301 @@ private:
     };
 };
 
+template <class Weight> const unsigned int Graph<Weight>::NO_VERTEX;
+
+/*
+   Specialisation for unweighted graphs (e.g. the Board's connectivity graphs).
+   The adjacency matrix is stored at 1 bit per edge in row-major 64-bit words,
+   so each vertex's neighbours are a contiguous bitset. Both halves of the
+   matrix are kept so a row can be scanned word by word without consulting 
+   the other triangle.
+*/
+template <> class Graph<bool> {
+private:
+    typedef uint64_t Word;
+    static const unsigned int WORD_BITS = 64;
+
+    unsigned int noOfVertices;        // Number of vertices in Graph
+    unsigned int wordsPerRow;         // Number of words in each adjacency row
+    Word* adjacency;                  // noOfVertices rows of wordsPerRow words
+    // If MST has been calculated for some subsection of an MST
+    // then calculating the new MST is faster
+    Graph* cachedKMST = NULL;   // Kruskals
+    bool changedKMST = true;
+    const bool DISCONNECTED;    // For disconnected vertices
+public:
+    // Creates a deep copy of another graph
+    Graph(const Graph<bool>& graph): noOfVertices(graph.noOfVertices),
+            wordsPerRow(graph.wordsPerRow), DISCONNECTED(graph.DISCONNECTED){
+            unsigned long size = (unsigned long)noOfVertices * wordsPerRow;
+            adjacency = new Word[size];
+            for (unsigned long i = 0; i < size; i++) {
+               adjacency[i] = graph.adjacency[i];
+            }
+            if (graph.cachedKMST != NULL) {
+                  cachedKMST = new Graph<bool>(*graph.cachedKMST);
+            }
+            changedKMST = graph.changedKMST;
+   }
+
+    // Creates an empty Graph
+    Graph(bool disconnected, unsigned int noOfVertices): DISCONNECTED(disconnected) {
+        init(noOfVertices);
+   }
+    Graph(bool disconnected, std::string filename):DISCONNECTED(disconnected) {
+         // Read through the file
+         ifstream datafile(filename);
+
+         if (datafile.is_open()) {
+            unsigned int vertex1, vertex2;
+            bool weight;
+            // First line is the number of vertices
+            datafile >> noOfVertices;
+            init(noOfVertices);
+            // The remainder is a connection list
+            while (datafile >> vertex1 >> vertex2 >> weight) {
+                     setWeight(vertex1, vertex2, weight);
+            }
+            datafile.close();
+         } else {
+            throw runtime_error("Could not open file");
+         }
+   }
+
+    // Creates a random graph, generated the same way as the weighted graphs
+    Graph(bool disconnected, unsigned int noOfVertices, double edgeDensity,
+         bool min, bool max, bool fullyConnected):Graph(disconnected, noOfVertices) {
+
+         // Calcuate size (number of edges if fully connected) and number of edges
+         unsigned long size = ((unsigned long)noOfVertices * (noOfVertices - 1)) / 2;
+         unsigned long noOfEdges = (unsigned long)(size * edgeDensity);
+
+         // Check the input arguments are valid
+         if (edgeDensity < 0 || edgeDensity > 1) {
+            throw out_of_range("edgeDensity must be between 0 and 1 inclusive");
+         }
+         if (min > max) {
+            throw out_of_range("Input arguments must be 0 <= min <= max");
+         }
+         // Check if there are enough edges to create fully connected graph
+         if (fullyConnected && noOfVertices - 1 > noOfEdges) {
+            throw out_of_range("edgeDensity/noOfVertices too low to create a \
+                                       fully connected graph");
+         }
+
+         // Initialize random seed based on current time
+         srand(time(NULL));
+         // Initially all edges are unallocated
+         unsigned long unallocatedEdges = noOfEdges;
+
+         // If requested, make a random fully connected graph
+         if (fullyConnected) {
+            // Create a shuffled array of vertices
+            unsigned int* shuffled = new unsigned int[noOfVertices];
+            for (unsigned int i = 0; i < noOfVertices; i++) {
+                  shuffled[i] = i;
+            }
+            random_shuffle(&shuffled[0], &shuffled[noOfVertices]);
+            // Connect each vertex to a random one earlier in the shuffle
+            for (unsigned int i = 1; i < noOfVertices; i++) {
+                  int cIndex = rand() % i;
+                  unallocatedEdges--;
+                  bool weight = (bool)(rand() % (max - min + 1) + min);
+                  setWeight(shuffled[i], shuffled[cIndex], weight);
+            }
+            // Remove shuffled array
+            delete[] shuffled;
+         }
+         // Visit the edges in the same order as the weighted graph's weights
+         // array, i.e. i = 0..size-1 over vertex1 < vertex2
+         unsigned long i = 0;
+         for (unsigned int vertex1 = 0; vertex1 < noOfVertices; vertex1++) {
+            for (unsigned int vertex2 = vertex1 + 1; vertex2 < noOfVertices; vertex2++, i++) {
+                  // If it doesn't yet exist, decide if this edge will exist
+                  if (!hasEdge(vertex1, vertex2) &&
+                        (unsigned long)rand() * (size - i) < (unsigned long)
+                        unallocatedEdges * ((unsigned long)RAND_MAX + 1)) {
+                     unallocatedEdges--;
+                     setWeight(vertex1, vertex2,
+                           (bool)(rand() % (max - min + 1) + min));
+                  }
+            }
+         }
+      }
+
+    ~Graph(){
+         delete[] adjacency;
+         delete cachedKMST;
+      }
+
+   // Returns weight between 2 vertices. DISCONNECTED indicates they are not
+   // connected. The weight between a vertex and itself is false
+    bool getWeight(unsigned int vertex1, unsigned int vertex2){
+         if (vertex1 == vertex2) {
+            return false;
+         }
+         return hasEdge(vertex1, vertex2) ? !DISCONNECTED : DISCONNECTED;
+      }
+
+    // Returns an array of weights between the specified vertex and all others
+    bool* getWeights(unsigned int vertex){
+         bool* weights = new bool[noOfVertices];
+         for (unsigned int i = 0; i < noOfVertices; i++) {
+            weights[i] = DISCONNECTED;
+         }
+         weights[vertex] = false;
+         const Word* row = getRow(vertex);
+         for (unsigned int w = 0; w < wordsPerRow; w++) {
+            Word word = row[w];
+            while (word != 0) {
+                  weights[w * WORD_BITS + __builtin_ctzll(word)] = !DISCONNECTED;
+                  word &= word - 1;
+            }
+         }
+         return weights;
+      }
+
+   // Sets weight between 2 vertices. DISCONNECTED indicates they are not 
+   // connected
+    void setWeight(unsigned int vertex1, unsigned int vertex2, bool weight){
+         if (vertex1 == vertex2) {
+            throw out_of_range("setWeight cannot be called with vertex1 == vertex2");
+         }
+         if (vertex1 >= noOfVertices || vertex2 >= noOfVertices) {
+            throw out_of_range("setWeight called with vertex out of range");
+         }
+         setBit(vertex1, vertex2, weight != DISCONNECTED);
+         setBit(vertex2, vertex1, weight != DISCONNECTED);
+         changedKMST = true;
+      }
+
+    /* Returns true if vertex1 is connected to vertex2, directly or indirectly.
+       As for weighted graphs, a vertex is only connected to itself if it has
+       a neighbour. The search expands a bitset frontier one OR per word of
+       each frontier vertex's row, so cache is accepted for compatibility but
+       not needed.
+    */
+    bool isConnected(unsigned int vertex1, unsigned int vertex2, bool cache = false){
+         (void)cache;
+         if (vertex1 == vertex2) {
+            const Word* row = getRow(vertex1);
+            for (unsigned int w = 0; w < wordsPerRow; w++) {
+                  if (row[w] != 0) {
+                     return true;
+                  }
+            }
+            return false;
+         }
+         Word* visited = new Word[wordsPerRow]();
+         Word* frontier = new Word[wordsPerRow]();
+         Word* next = new Word[wordsPerRow];
+         const unsigned int targetWord = vertex2 / WORD_BITS;
+         const Word targetBit = Word(1) << (vertex2 % WORD_BITS);
+         visited[vertex1 / WORD_BITS] |= Word(1) << (vertex1 % WORD_BITS);
+         frontier[vertex1 / WORD_BITS] |= Word(1) << (vertex1 % WORD_BITS);
+         bool found = false;
+         bool expanding = true;
+         while (expanding && !found) {
+            // Union of the neighbours of every vertex in the frontier
+            for (unsigned int w = 0; w < wordsPerRow; w++) {
+                  next[w] = 0;
+            }
+            for (unsigned int fw = 0; fw < wordsPerRow; fw++) {
+                  Word word = frontier[fw];
+                  while (word != 0) {
+                     unsigned int vertex = fw * WORD_BITS + __builtin_ctzll(word);
+                     const Word* row = getRow(vertex);
+                     for (unsigned int w = 0; w < wordsPerRow; w++) {
+                        next[w] |= row[w];
+                     }
+                     word &= word - 1;
+                  }
+            }
+            // Only unvisited vertices form the next frontier
+            expanding = false;
+            for (unsigned int w = 0; w < wordsPerRow; w++) {
+                  next[w] &= ~visited[w];
+                  visited[w] |= next[w];
+                  if (next[w] != 0) {
+                     expanding = true;
+                  }
+            }
+            found = (next[targetWord] & targetBit) != 0;
+            Word* temp = frontier;
+            frontier = next;
+            next = temp;
+         }
+         delete[] visited;
+         delete[] frontier;
+         delete[] next;
+         return found;
+      }
+
+    // Returns a new graph which is a minimum spanning tree (forest) of this 
+    // graph. All edges have equal weight, so any spanning forest is minimal 
+    // and one is built by breadth first search.
+    Graph* getKruskalsMinimumSpanningTree(){
+         if (!changedKMST) {
+            return cachedKMST;
+         }
+         Graph<bool>* graph = new Graph<bool>(DISCONNECTED, noOfVertices);
+         Word* visited = new Word[wordsPerRow]();
+         unsigned int* queue = new unsigned int[noOfVertices];
+         for (unsigned int root = 0; root < noOfVertices; root++) {
+            if (visited[root / WORD_BITS] & (Word(1) << (root % WORD_BITS))) {
+                  continue;
+            }
+            visited[root / WORD_BITS] |= Word(1) << (root % WORD_BITS);
+            unsigned int head = 0;
+            unsigned int tail = 0;
+            queue[tail++] = root;
+            while (head < tail) {
+                  unsigned int vertex = queue[head++];
+                  const Word* row = getRow(vertex);
+                  for (unsigned int w = 0; w < wordsPerRow; w++) {
+                     Word word = row[w] & ~visited[w];
+                     visited[w] |= word;
+                     while (word != 0) {
+                        unsigned int adj = w * WORD_BITS + __builtin_ctzll(word);
+                        graph->setBit(vertex, adj, true);
+                        graph->setBit(adj, vertex, true);
+                        queue[tail++] = adj;
+                        word &= word - 1;
+                     }
+                  }
+            }
+         }
+         delete[] visited;
+         delete[] queue;
+         delete cachedKMST;
+         cachedKMST = graph;
+         changedKMST = false;
+         return graph;
+      }
+
+private:
+    // Initializes as empty graph of required size
+    void init(unsigned int noOfVertices){
+         this->noOfVertices = noOfVertices;
+         this->wordsPerRow = (noOfVertices + WORD_BITS - 1) / WORD_BITS;
+         // Setup adjacency matrix as completely unconnected
+         this->adjacency = new Word[(unsigned long)noOfVertices * wordsPerRow]();
+      }
+    // Returns the adjacency row of the specified vertex
+    Word* getRow(unsigned int vertex){
+         return adjacency + (unsigned long)vertex * wordsPerRow;
+      }
+    bool hasEdge(unsigned int vertex1, unsigned int vertex2){
+         return (getRow(vertex1)[vertex2 / WORD_BITS] >> (vertex2 % WORD_BITS)) & 1;
+      }
+    void setBit(unsigned int vertex1, unsigned int vertex2, bool value){
+         Word mask = Word(1) << (vertex2 % WORD_BITS);
+         if (value) {
+            getRow(vertex1)[vertex2 / WORD_BITS] |= mask;
+         } else {
+            getRow(vertex1)[vertex2 / WORD_BITS] &= ~mask;
+         }
+      }
+};
+
 #endif  // GRAPH_H_
\ No newline at end of file
@@ -0,0 +1,146 @@
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/*
+   A fixed set of worker threads which repeatedly run parallel loops. The
+   calling thread takes part in each loop as worker 0, so a pool of 1 thread
+   has no workers and runs everything inline. parallelFor must not be called
+   again from inside one of its own tasks.
+*/
+class ThreadPool {
+private:
+    vector<thread> workers;
+    mutex lock;
+    condition_variable started;       // Signalled when a new loop starts
+    condition_variable finished;      // Signalled when the last worker is done
+    unsigned long generation = 0;     // Incremented for every loop
+    unsigned int active = 0;          // Workers still running the loop
+    bool stopping = false;
+    // The current loop
+    const function<void(unsigned int, unsigned long)>* task = NULL;
+    atomic<unsigned long> next;
+    unsigned long count = 0;
+    exception_ptr error;
+public:
+    // Creates a pool of noOfThreads threads, including the calling thread.
+    // 0 uses the number of hardware threads.
+    ThreadPool(unsigned int noOfThreads = 0): next(0) {
+         if (noOfThreads == 0) {
+            noOfThreads = thread::hardware_concurrency();
+         }
+         for (unsigned int id = 1; id < noOfThreads; id++) {
+            workers.push_back(thread(&ThreadPool::work, this, id));
+         }
+      }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool(){
+         {
+            unique_lock<mutex> guard(lock);
+            stopping = true;
+         }
+         started.notify_all();
+         for (unsigned int i = 0; i < workers.size(); i++) {
+            workers[i].join();
+         }
+      }
+
+    // Returns the number of threads, including the calling thread
+    unsigned int getNoOfThreads() const{
+         return workers.size() + 1;
+      }
+
+    /* Calls task(worker, index) for every index in [0, count) across the
+       pool and returns once all have completed. worker is in
+       [0, getNoOfThreads()) and no two tasks run on the same worker at once,
+       so it can index per-thread buffers. The first exception thrown by a
+       task is rethrown here.
+    */
+    void parallelFor(unsigned long count,
+         const function<void(unsigned int, unsigned long)>& task){
+         if (count == 0) {
+            return;
+         }
+         if (workers.empty() || count == 1) {
+            for (unsigned long i = 0; i < count; i++) {
+                  task(0, i);
+            }
+            return;
+         }
+         {
+            unique_lock<mutex> guard(lock);
+            this->task = &task;
+            this->count = count;
+            next = 0;
+            error = nullptr;
+            active = workers.size();
+            generation++;
+         }
+         started.notify_all();
+         runTask(0);
+         exception_ptr taskError;
+         {
+            unique_lock<mutex> guard(lock);
+            finished.wait(guard, [this]{ return active == 0; });
+            this->task = NULL;
+            taskError = error;
+            error = nullptr;
+         }
+         if (taskError) {
+            rethrow_exception(taskError);
+         }
+      }
+
+private:
+    void work(unsigned int id){
+         unsigned long seen = 0;
+         while (true) {
+            {
+                  unique_lock<mutex> guard(lock);
+                  started.wait(guard, [&]{ return stopping || generation != seen; });
+                  if (stopping) {
+                     return;
+                  }
+                  seen = generation;
+            }
+            runTask(id);
+            {
+                  unique_lock<mutex> guard(lock);
+                  if (--active == 0) {
+                     finished.notify_all();
+                  }
+            }
+         }
+      }
+
+    // Takes indices of the current loop until there are none left
+    void runTask(unsigned int id){
+         unsigned long i;
+         while ((i = next++) < count) {
+            try {
+                  (*task)(id, i);
+            } catch (...) {
+                  unique_lock<mutex> guard(lock);
+                  if (!error) {
+                     error = current_exception();
+                  }
+                  // Abandon the remaining indices
+                  next = count;
+            }
+         }
+      }
+};
+
+#endif  // THREADPOOL_H_
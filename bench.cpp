@@ -0,0 +1,73 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "Graph.cpp"
+
+using namespace std;
+
+/*
+   Benchmarks the shortest path algorithms on a graph from Graph's random
+   constructor and checks they agree.
+   Usage: bench.exe [vertices] [edgeDensity] [threads] [sources]
+*/
+
+double seconds(chrono::steady_clock::time_point start){
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+bool sameDistances(const Graph<int>::ShortestPaths& a, const Graph<int>::ShortestPaths& b){
+    return a.reached == b.reached && a.distances == b.distances;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned int noOfVertices = argc > 1 ? atoi(argv[1]) : 4000;
+    double edgeDensity = argc > 2 ? atof(argv[2]) : 0.01;
+    unsigned int noOfThreads = argc > 3 ? atoi(argv[3]) : 0;
+    unsigned int noOfSources = argc > 4 ? atoi(argv[4]) : 16;
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    Graph<int> graph(-1, noOfVertices, edgeDensity, 1, 100, true);
+    cout << "Random graph: " << noOfVertices << " vertices, density "
+         << edgeDensity << " (" << seconds(start) << "s)" << endl;
+    ThreadPool pool(noOfThreads);
+    cout << "Threads: " << pool.getNoOfThreads() << endl;
+
+    start = chrono::steady_clock::now();
+    Graph<int>::ShortestPaths dijkstra = graph.getDijkstrasShortestPaths(0);
+    cout << "Dijkstra:                 " << seconds(start) << "s" << endl;
+
+    start = chrono::steady_clock::now();
+    Graph<int>::ShortestPaths target = graph.getDijkstrasShortestPaths(0, noOfVertices - 1);
+    cout << "Dijkstra to target:       " << seconds(start) << "s, distance "
+         << target.getDistance(noOfVertices - 1) << ", "
+         << target.getPath(noOfVertices - 1).size() << " vertices on path" << endl;
+
+    start = chrono::steady_clock::now();
+    Graph<int>::ShortestPaths delta = graph.getDeltaSteppingShortestPaths(0, pool);
+    cout << "Delta-stepping:           " << seconds(start) << "s" << endl;
+
+    vector<unsigned int> sources;
+    for (unsigned int i = 0; i < noOfSources; i++) {
+        sources.push_back((unsigned long)i * noOfVertices / noOfSources);
+    }
+    start = chrono::steady_clock::now();
+    vector<Graph<int>::ShortestPaths> repeated;
+    for (unsigned int i = 0; i < sources.size(); i++) {
+        repeated.push_back(graph.getDijkstrasShortestPaths(sources[i]));
+    }
+    cout << "Dijkstra per source:      " << seconds(start) << "s ("
+         << noOfSources << " sources)" << endl;
+
+    start = chrono::steady_clock::now();
+    vector<Graph<int>::ShortestPaths> batched = graph.getShortestPaths(sources, pool);
+    cout << "Batched sources:          " << seconds(start) << "s" << endl;
+
+    bool agree = sameDistances(dijkstra, delta) &&
+        target.getDistance(noOfVertices - 1) == dijkstra.getDistance(noOfVertices - 1);
+    for (unsigned int i = 0; i < sources.size(); i++) {
+        agree = agree && sameDistances(repeated[i], batched[i]);
+    }
+    cout << (agree ? "Results agree" : "Results DIFFER") << endl;
+    return agree ? 0 : 1;
+}